@@ -20,7 +20,7 @@ namespace crubit {
 class Invocation {
  public:
   Invocation(BazelLabel target, absl::Span<const HeaderName> public_headers,
-             const absl::flat_hash_map<HeaderName, BazelLabel>& header_targets)
+             const HeaderNameToTargetMap& header_targets)
       : target_(target),
         public_headers_(public_headers),
         lifetime_context_(std::make_shared<
@@ -30,14 +30,19 @@ class Invocation {
     CHECK(!public_headers_.empty());
     CHECK(!header_targets_.empty());
 
+    ir_.public_headers.reserve(public_headers_.size());
     ir_.public_headers.insert(ir_.public_headers.end(), public_headers_.begin(),
                               public_headers.end());
     ir_.current_target = target_;
   }
 
-  // Returns the target of a header, if any.
-  std::optional<BazelLabel> header_target(const HeaderName header) const {
-    auto it = header_targets_.find(header);
+  // Returns the target of the header with the given include path, if any.
+  // Takes a plain `absl::string_view` so that callers probing the map in a
+  // loop (e.g. when walking an include stack) don't have to materialize a
+  // `HeaderName` per lookup.
+  std::optional<BazelLabel> header_target(
+      absl::string_view header_include_path) const {
+    auto it = header_targets_.find(header_include_path);
     return (it != header_targets_.end()) ? std::optional(it->second)
                                          : std::nullopt;
   }
@@ -56,7 +61,7 @@ class Invocation {
   IR ir_;
 
  private:
-  const absl::flat_hash_map<HeaderName, BazelLabel>& header_targets_;
+  const HeaderNameToTargetMap& header_targets_;
 };
 
 // Explicitly defined interface that defines how `DeclImporter`s are allowed to
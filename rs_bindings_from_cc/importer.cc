@@ -16,7 +16,6 @@
 #include <variant>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -27,7 +26,6 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
-#include "absl/strings/substitute.h"
 #include "common/status_macros.h"
 #include "lifetime_annotations/type_lifetimes.h"
 #include "rs_bindings_from_cc/ast_util.h"
@@ -49,7 +47,9 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Specifiers.h"
 #include "clang/Sema/Sema.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Regex.h"
@@ -188,56 +188,75 @@ static int GetDeclOrder(const clang::Decl* decl) {
   return 999;
 }
 
-class Importer::SourceOrderKey {
- public:
-  SourceOrderKey(clang::SourceRange source_range, int decl_order = 0,
-                 std::string name = "")
-      : source_range_(source_range), decl_order_(decl_order), name_(name) {}
-
-  SourceOrderKey(const SourceOrderKey&) = default;
-  SourceOrderKey& operator=(const SourceOrderKey&) = default;
-
-  bool isBefore(const SourceOrderKey& other,
-                const clang::SourceManager& sm) const {
-    if (!source_range_.isValid() || !other.source_range_.isValid()) {
-      if (source_range_.isValid() != other.source_range_.isValid())
-        return !source_range_.isValid() && other.source_range_.isValid();
-    } else {
-      if (source_range_.getBegin() != other.source_range_.getBegin()) {
-        return sm.isBeforeInTranslationUnit(source_range_.getBegin(),
-                                            other.source_range_.getBegin());
-      }
-      if (source_range_.getEnd() != other.source_range_.getEnd()) {
-        return sm.isBeforeInTranslationUnit(source_range_.getEnd(),
-                                            other.source_range_.getEnd());
+Importer::SourceOrderKey::SourceOrderKey(const clang::SourceManager& sm,
+                                         clang::SourceRange source_range,
+                                         int decl_order, std::string name)
+    : source_range_(source_range), decl_order_(decl_order), name_(name) {
+  // Decompose the range endpoints once at construction time.  The keys are
+  // compared O(N log N) times while sorting items, and within one file
+  // (the overwhelmingly common case) the comparison then reduces to a pair
+  // of integer compares instead of a `SourceManager` query.
+  if (source_range_.isValid()) {
+    decomposed_begin_ = sm.getDecomposedLoc(source_range_.getBegin());
+    decomposed_end_ = sm.getDecomposedLoc(source_range_.getEnd());
+  }
+}
+
+bool Importer::SourceOrderKey::isBefore(const SourceOrderKey& other,
+                                        const clang::SourceManager& sm) const {
+  if (!source_range_.isValid() || !other.source_range_.isValid()) {
+    if (source_range_.isValid() != other.source_range_.isValid())
+      return !source_range_.isValid() && other.source_range_.isValid();
+  } else {
+    if (source_range_.getBegin() != other.source_range_.getBegin()) {
+      // Same file: compare the cached file offsets directly; this is
+      // exactly the same-FileID fast path of `isBeforeInTranslationUnit`,
+      // minus the repeated decomposition.
+      if (decomposed_begin_.first == other.decomposed_begin_.first) {
+        return decomposed_begin_.second < other.decomposed_begin_.second;
       }
+      return sm.isBeforeInTranslationUnit(source_range_.getBegin(),
+                                          other.source_range_.getBegin());
     }
-
-    if (decl_order_ < other.decl_order_) {
-      return true;
-    } else if (decl_order_ > other.decl_order_) {
-      return false;
+    if (source_range_.getEnd() != other.source_range_.getEnd()) {
+      if (decomposed_end_.first == other.decomposed_end_.first) {
+        return decomposed_end_.second < other.decomposed_end_.second;
+      }
+      return sm.isBeforeInTranslationUnit(source_range_.getEnd(),
+                                          other.source_range_.getEnd());
     }
-    return name_ < other.name_;
   }
 
- private:
-  clang::SourceRange source_range_;
-  int decl_order_;
-  std::string name_;
-};
+  if (decl_order_ < other.decl_order_) {
+    return true;
+  } else if (decl_order_ > other.decl_order_) {
+    return false;
+  }
+  return name_ < other.name_;
+}
 
 Importer::SourceOrderKey Importer::GetSourceOrderKey(
     const clang::Decl* decl) const {
-  return SourceOrderKey(decl->getSourceRange(), GetDeclOrder(decl),
-                        GetNameForSourceOrder(decl));
+  auto it = source_order_key_cache_.find(decl);
+  if (it != source_order_key_cache_.end()) {
+    return it->second;
+  }
+  SourceOrderKey key(ctx_.getSourceManager(), decl->getSourceRange(),
+                     GetDeclOrder(decl), GetNameForSourceOrder(decl));
+  source_order_key_cache_.try_emplace(decl, key);
+  return key;
 }
 
 Importer::SourceOrderKey Importer::GetSourceOrderKey(
     const clang::RawComment* comment) const {
-  return SourceOrderKey(comment->getSourceRange());
+  return SourceOrderKey(ctx_.getSourceManager(), comment->getSourceRange());
 }
 
+// Orders locations, comments and items by their position in the translation
+// unit.  All comparisons go through `isBeforeInTranslationUnit` (or the
+// cached decomposed offsets in `SourceOrderKey`): `SourceLocation`'s raw
+// `operator<` compares raw encodings and is only meaningful for locations
+// within the same FileID, so it must not be used here.
 class Importer::SourceLocationComparator {
  public:
   const bool operator()(const clang::SourceLocation& a,
@@ -258,12 +277,14 @@ class Importer::SourceLocationComparator {
   }
 
   using OrderedItemId = std::pair<SourceOrderKey, ItemId>;
-  using OrderedItem = std::pair<SourceOrderKey, IR::Item>;
+  // Indexes into a side vector of `IR::Item`s; sorting these instead of the
+  // items themselves keeps the sort's swaps cheap (see `Importer::Import`).
+  using OrderedItemIdx = std::pair<SourceOrderKey, size_t>;
 
   template <typename OrderedItemOrId>
   bool operator()(const OrderedItemOrId& a, const OrderedItemOrId& b) const {
-    auto a_source_order = a.first;
-    auto b_source_order = b.first;
+    const auto& a_source_order = a.first;
+    const auto& b_source_order = b.first;
     return a_source_order.isBefore(b_source_order, sm);
   }
   SourceLocationComparator(const clang::SourceManager& sm) : sm(sm) {}
@@ -309,19 +330,35 @@ std::vector<ItemId> Importer::GetItemIdsInSourceOrder(
   std::vector<SourceLocationComparator::OrderedItemId> items;
   auto compare_locations = SourceLocationComparator(sm);
 
-  // We are only interested in comments within this decl context.
-  std::vector<const clang::RawComment*> comments_in_range(
-      llvm::lower_bound(comments_, parent_decl->getBeginLoc(),
-                        compare_locations),
-      llvm::upper_bound(comments_, parent_decl->getEndLoc(),
-                        compare_locations));
-
-  std::map<clang::SourceLocation, const clang::RawComment*,
-           SourceLocationComparator>
-      ordered_comments(compare_locations);
-  for (auto& comment : comments_in_range) {
-    ordered_comments.insert({comment->getBeginLoc(), comment});
+  // We are only interested in comments within this decl context.  `comments_`
+  // is sorted, so the slice is already in source order; keep it as a flat
+  // (location, comment) vector and "erase" entries by nulling the comment
+  // pointer, which keeps binary searches on the locations valid without the
+  // node allocations and rebalancing of an ordered map.
+  std::vector<std::pair<clang::SourceLocation, const clang::RawComment*>>
+      ordered_comments;
+  auto comments_begin = llvm::lower_bound(comments_, parent_decl->getBeginLoc(),
+                                          compare_locations);
+  auto comments_end = llvm::upper_bound(comments_, parent_decl->getEndLoc(),
+                                        compare_locations);
+  ordered_comments.reserve(comments_end - comments_begin);
+  for (auto it = comments_begin; it != comments_end; ++it) {
+    ordered_comments.push_back({(*it)->getBeginLoc(), *it});
   }
+  auto comment_lower_bound = [&](clang::SourceLocation loc) {
+    return std::lower_bound(
+        ordered_comments.begin(), ordered_comments.end(), loc,
+        [&](const auto& entry, clang::SourceLocation l) {
+          return compare_locations(entry.first, l);
+        });
+  };
+  auto comment_upper_bound = [&](clang::SourceLocation loc) {
+    return std::upper_bound(
+        ordered_comments.begin(), ordered_comments.end(), loc,
+        [&](clang::SourceLocation l, const auto& entry) {
+          return compare_locations(l, entry.first);
+        });
+  };
 
   absl::flat_hash_set<ItemId> visited_item_ids;
 
@@ -339,22 +376,29 @@ std::vector<ItemId> Importer::GetItemIdsInSourceOrder(
       auto item_id = GenerateItemId(decl);
       // TODO(rosica): Drop this check when we start importing also other
       // redecls, not just the canonical
-      if (visited_item_ids.find(item_id) == visited_item_ids.end()) {
-        visited_item_ids.insert(item_id);
+      if (visited_item_ids.insert(item_id).second) {
         items.push_back({GetSourceOrderKey(decl), item_id});
       }
     }
 
     // We remove comments attached to a child decl or that are within a child
     // decl.
-    if (auto raw_comment = ctx_.getRawCommentForDeclNoCache(decl)) {
-      ordered_comments.erase(raw_comment->getBeginLoc());
+    if (const auto* raw_comment = GetRawComment(decl)) {
+      if (auto it = comment_lower_bound(raw_comment->getBeginLoc());
+          it != ordered_comments.end() &&
+          it->first == raw_comment->getBeginLoc()) {
+        it->second = nullptr;
+      }
+    }
+    for (auto it = comment_lower_bound(decl->getBeginLoc()),
+              end = comment_upper_bound(decl->getEndLoc());
+         it != end; ++it) {
+      it->second = nullptr;
     }
-    ordered_comments.erase(ordered_comments.lower_bound(decl->getBeginLoc()),
-                           ordered_comments.upper_bound(decl->getEndLoc()));
   }
 
-  for (auto& [_, comment] : ordered_comments) {
+  for (const auto& [_, comment] : ordered_comments) {
+    if (comment == nullptr) continue;
     items.push_back({GetSourceOrderKey(comment), GenerateItemId(comment)});
   }
   llvm::sort(items, compare_locations);
@@ -389,10 +433,17 @@ std::vector<ItemId> Importer::GetOrderedItemIdsOfTemplateInstantiations()
 
 void Importer::ImportFreeComments() {
   clang::SourceManager& sm = ctx_.getSourceManager();
+  // Several public headers can resolve to the same FileID (e.g. the same file
+  // reachable under multiple include paths); visit each file's comment map
+  // only once so its comments are neither re-scanned nor duplicated.
+  llvm::DenseSet<clang::FileID> visited_file_ids;
   for (const auto& header : invocation_.public_headers_) {
     if (auto file = sm.getFileManager().getFile(header.IncludePath())) {
-      if (auto comments_in_file = ctx_.Comments.getCommentsInFile(
-              sm.getOrCreateFileID(*file, clang::SrcMgr::C_User))) {
+      clang::FileID file_id =
+          sm.getOrCreateFileID(*file, clang::SrcMgr::C_User);
+      if (!visited_file_ids.insert(file_id).second) continue;
+      if (auto comments_in_file = ctx_.Comments.getCommentsInFile(file_id)) {
+        comments_.reserve(comments_.size() + comments_in_file->size());
         for (const auto& [_, comment] : *comments_in_file) {
           comments_.push_back(comment);
         }
@@ -405,15 +456,25 @@ void Importer::ImportFreeComments() {
 void Importer::Import(clang::TranslationUnitDecl* translation_unit_decl) {
   ImportFreeComments();
   clang::SourceManager& sm = ctx_.getSourceManager();
-  std::vector<SourceLocationComparator::OrderedItem> ordered_items;
+  // `IR::Item` is a wide variant (strings, vectors); sort (key, index) pairs
+  // and leave the items in place, so the sort swaps indices instead of
+  // variant payloads.
+  std::vector<IR::Item> items;
+  std::vector<SourceLocationComparator::OrderedItemIdx> ordered_item_idxs;
 
   for (auto& comment : comments_) {
-    ordered_items.push_back(
-        {GetSourceOrderKey(comment),
-         Comment{.text = comment->getFormattedText(sm, sm.getDiagnostics()),
-                 .id = GenerateItemId(comment)}});
+    ordered_item_idxs.push_back({GetSourceOrderKey(comment), items.size()});
+    items.push_back(
+        Comment{.text = comment->getFormattedText(sm, sm.getDiagnostics()),
+                .id = GenerateItemId(comment)});
   }
 
+  // Note: this deliberately walks every top-level decl of the TU rather than
+  // restricting the walk (e.g. via `ASTContext::setTraversalScope`) to decls
+  // from the current target's headers: decls from other targets still need IR
+  // items so that cross-target references (field types, base classes, ...)
+  // resolve, and the per-decl work for foreign decls is already bounded by
+  // the `import_cache_` / `GetOwningTarget` caches.
   ImportDeclsFromDeclContext(translation_unit_decl);
   for (const auto& [decl, item] : import_cache_) {
     if (item.has_value()) {
@@ -421,15 +482,16 @@ void Importer::Import(clang::TranslationUnitDecl* translation_unit_decl) {
           !IsFromCurrentTarget(decl)) {
         continue;
       }
-      ordered_items.push_back({GetSourceOrderKey(decl), *item});
+      ordered_item_idxs.push_back({GetSourceOrderKey(decl), items.size()});
+      items.push_back(*item);
     }
   }
 
-  llvm::sort(ordered_items, SourceLocationComparator(sm));
+  llvm::sort(ordered_item_idxs, SourceLocationComparator(sm));
 
-  invocation_.ir_.items.reserve(ordered_items.size());
-  for (auto& ordered_item : ordered_items) {
-    invocation_.ir_.items.push_back(ordered_item.second);
+  invocation_.ir_.items.reserve(items.size());
+  for (const auto& [_, idx] : ordered_item_idxs) {
+    invocation_.ir_.items.push_back(std::move(items[idx]));
   }
   invocation_.ir_.top_level_item_ids =
       GetItemIdsInSourceOrder(translation_unit_decl);
@@ -442,6 +504,12 @@ void Importer::Import(clang::TranslationUnitDecl* translation_unit_decl) {
 
 void Importer::ImportDeclsFromDeclContext(
     const clang::DeclContext* decl_context) {
+  // Redeclarations (`void Foo(); void Foo();`) are deduplicated here at
+  // insertion time: the walk only visits canonical decls, and `GetDeclItem`
+  // caches per canonical decl, so a redeclaration costs one pointer-keyed
+  // `import_cache_` probe -- the duplicate's `Func` (and its `MappedType`
+  // conversions) is never built, and no post-hoc uniqueness pass over the
+  // item list is needed.
   for (auto decl : GetCanonicalChildren(decl_context)) {
     GetDeclItem(decl);
   }
@@ -511,12 +579,15 @@ std::optional<IR::Item> Importer::GetDeclItem(clang::Decl* decl) {
     // import the parent? For now we have tests that check that we generate
     // error messages for those decls, so we're visiting.
     ImportDeclsFromDeclContext(record_decl);
-  }
-  if (auto* specialization_decl =
-          llvm::dyn_cast<clang::ClassTemplateSpecializationDecl>(decl)) {
-    // Store `specialization_decl`s so that they will get included in
-    // IR::top_level_item_ids.
-    class_template_instantiations_.insert(specialization_decl);
+    // `ClassTemplateSpecializationDecl` is a subclass of `CXXRecordDecl`, so
+    // the second classification only needs to run inside this branch.
+    if (auto* specialization_decl =
+            llvm::dyn_cast<clang::ClassTemplateSpecializationDecl>(
+                record_decl)) {
+      // Store `specialization_decl`s so that they will get included in
+      // IR::top_level_item_ids.
+      class_template_instantiations_.insert(specialization_decl);
+    }
   }
   return result;
 }
@@ -575,6 +646,39 @@ BazelLabel Importer::GetOwningTarget(const clang::Decl* decl) const {
 
   clang::SourceManager& source_manager = ctx_.getSourceManager();
   auto source_location = decl->getLocation();
+  if (source_location.isMacroID()) {
+    source_location = source_manager.getExpansionLoc(source_location);
+  }
+
+  // All decls within one file resolve to the same target, and the lookup below
+  // can walk the whole include stack (building a `HeaderName` at every hop),
+  // so memoize the result per `FileID`.  `GetOwningTarget` is called at least
+  // twice per decl (via `IsFromCurrentTarget` and again during import).
+  clang::FileID file_id = source_manager.getFileID(source_location);
+  // One-entry fast path in front of the map: consecutive decls almost always
+  // live in the same file, so this usually turns the lookup into a single
+  // compare (the same idea as `SourceManager`'s internal LastFileIDLookup).
+  if (file_id.isValid() && file_id == last_owning_file_id_) {
+    return last_owning_target_;
+  }
+  BazelLabel target;
+  if (auto it = owning_target_cache_.find(file_id);
+      it != owning_target_cache_.end()) {
+    target = it->second;
+  } else {
+    target = GetOwningTargetUncached(source_location);
+    owning_target_cache_.insert({file_id, target});
+  }
+  if (file_id.isValid()) {
+    last_owning_file_id_ = file_id;
+    last_owning_target_ = target;
+  }
+  return target;
+}
+
+BazelLabel Importer::GetOwningTargetUncached(
+    clang::SourceLocation source_location) const {
+  clang::SourceManager& source_manager = ctx_.getSourceManager();
 
   // If the header this decl comes from is not associated with a target we
   // consider it a textual header. In that case we go up the include stack
@@ -594,7 +698,8 @@ BazelLabel Importer::GetOwningTarget(const clang::Decl* decl) const {
       filename = filename->substr(2);
     }
 
-    if (auto target = invocation_.header_target(HeaderName(filename->str()))) {
+    if (auto target = invocation_.header_target(
+            absl::string_view(filename->data(), filename->size()))) {
       return *target;
     }
     source_location = source_manager.getIncludeLoc(id);
@@ -604,7 +709,26 @@ BazelLabel Importer::GetOwningTarget(const clang::Decl* decl) const {
 }
 
 bool Importer::IsFromCurrentTarget(const clang::Decl* decl) const {
-  return invocation_.target_ == GetOwningTarget(decl);
+  // Like the owning target itself, the answer is a per-file constant (modulo
+  // the template-instantiation special case below), and this predicate guards
+  // every importer's entry point, so cache the boolean per `FileID` and skip
+  // the `BazelLabel` copy + string compare that `GetOwningTarget` would cost
+  // on every call.
+  if (IsFullClassTemplateSpecializationOrChild(decl)) {
+    return true;
+  }
+  clang::SourceManager& source_manager = ctx_.getSourceManager();
+  auto source_location = decl->getLocation();
+  if (source_location.isMacroID()) {
+    source_location = source_manager.getExpansionLoc(source_location);
+  }
+  clang::FileID file_id = source_manager.getFileID(source_location);
+  auto [it, inserted] =
+      is_from_current_target_cache_.try_emplace(file_id, false);
+  if (inserted) {
+    it->second = invocation_.target_ == GetOwningTarget(decl);
+  }
+  return it->second;
 }
 
 IR::Item Importer::ImportUnsupportedItem(const clang::Decl* decl,
@@ -635,13 +759,44 @@ static bool ShouldKeepCommentLine(absl::string_view line) {
   return !patterns_to_ignore.match(line);
 }
 
+const clang::RawComment* Importer::GetRawComment(
+    const clang::Decl* decl) const {
+  // `getRawCommentForDeclNoCache` re-scans the source text around the decl on
+  // every call (and, as its name says, does not cache); each imported decl
+  // needs the comment both for its own doc comment and when its parent
+  // collects item ids, so memoize the lookup per decl.
+  auto [it, inserted] = raw_comment_cache_.try_emplace(decl, nullptr);
+  if (inserted && FileHasComments(decl->getBeginLoc())) {
+    it->second = ctx_.getRawCommentForDeclNoCache(decl);
+  }
+  return it->second;
+}
+
+bool Importer::FileHasComments(clang::SourceLocation loc) const {
+  // Most files (in particular most system headers) contain no doc comments
+  // at all; in that case the answer for every decl in the file is negative,
+  // and the comment-attachment search in `getRawCommentForDeclNoCache` can be
+  // skipped wholesale.  This is a per-file yes/no rather than a per-offset
+  // filter on purpose: an approximate offset filter could produce false
+  // negatives (e.g. for trailing `///<` comments) and silently drop doc
+  // comments.
+  clang::FileID file_id =
+      ctx_.getSourceManager().getDecomposedExpansionLoc(loc).first;
+  auto [it, inserted] = file_has_comments_cache_.try_emplace(file_id, false);
+  if (inserted) {
+    const auto* comments_in_file = ctx_.Comments.getCommentsInFile(file_id);
+    it->second = comments_in_file != nullptr && !comments_in_file->empty();
+  }
+  return it->second;
+}
+
 std::optional<std::string> Importer::GetComment(const clang::Decl* decl) const {
   // This does currently not distinguish between different types of comments.
   // In general it is not possible in C++ to reliably only extract doc comments.
   // This is going to be a heuristic that needs to be tuned over time.
 
   clang::SourceManager& sm = ctx_.getSourceManager();
-  clang::RawComment* raw_comment = ctx_.getRawCommentForDeclNoCache(decl);
+  const clang::RawComment* raw_comment = GetRawComment(decl);
 
   if (raw_comment == nullptr) {
     return {};
@@ -669,34 +824,51 @@ std::string Importer::ConvertSourceLocation(clang::SourceLocation loc) const {
   constexpr absl::string_view kExpandedAt = "Expanded at";
   constexpr auto kSourceLocationFunc =
       [](absl::string_view origin, absl::string_view filename, uint32_t line) {
-        return absl::Substitute("$0: google3/$1;l=$2", origin, filename, line);
+        return absl::StrCat(origin, ": google3/", filename, ";l=", line);
       };
   constexpr absl::string_view kSourceLocUnknown = "<unknown location>";
+  // Returns the filename of `fid` (stripped of a leading "./"), memoized per
+  // FileID: many decls share few files, and `getFilename` re-derives the name
+  // from the FileEntry on every call.  Empty when the file is unknown.
+  const auto cached_filename =
+      [this, &sm](clang::FileID fid,
+                  clang::SourceLocation loc_in_file) -> absl::string_view {
+    auto [it, inserted] = filename_cache_.try_emplace(fid);
+    if (inserted) {
+      absl::string_view filename = sm.getFilename(loc_in_file);
+      if (absl::StartsWith(filename, "./")) {
+        filename = filename.substr(2);
+      }
+      it->second = std::string(filename);
+    }
+    return it->second;
+  };
+  // Decompose each location once; the line numbers below reuse the
+  // decomposition instead of re-querying the `SourceManager` by location.
+  const auto [spelling_fid, spelling_offset] =
+      sm.getDecomposedSpellingLoc(loc);
   std::string spelling_loc_str;
-  if (absl::string_view spelling_filename = sm.getFilename(spelling_loc);
+  if (absl::string_view spelling_filename =
+          cached_filename(spelling_fid, spelling_loc);
       spelling_filename.empty()) {
     spelling_loc_str = kSourceLocUnknown;
   } else {
-    uint32_t spelling_line = sm.getSpellingLineNumber(loc);
-    if (absl::StartsWith(spelling_filename, "./")) {
-      spelling_filename = spelling_filename.substr(2);
-    }
+    uint32_t spelling_line = sm.getLineNumber(spelling_fid, spelling_offset);
     spelling_loc_str =
         kSourceLocationFunc(kGeneratedFrom, spelling_filename, spelling_line);
   }
   if (!loc.isMacroID()) {
     return spelling_loc_str;
   }
-  const clang::SourceLocation& expansion_loc = sm.getExpansionLoc(loc);
+  const auto [expansion_fid, expansion_offset] =
+      sm.getDecomposedExpansionLoc(loc);
   std::string expansion_loc_str;
-  if (absl::string_view expansion_filename = sm.getFilename(expansion_loc);
+  if (absl::string_view expansion_filename =
+          cached_filename(expansion_fid, sm.getExpansionLoc(loc));
       expansion_filename.empty()) {
     expansion_loc_str = kSourceLocUnknown;
   } else {
-    uint32_t expansion_line = sm.getExpansionLineNumber(loc);
-    if (absl::StartsWith(expansion_filename, "./")) {
-      expansion_filename = expansion_filename.substr(2);
-    }
+    uint32_t expansion_line = sm.getLineNumber(expansion_fid, expansion_offset);
     expansion_loc_str =
         kSourceLocationFunc(kExpandedAt, expansion_filename, expansion_line);
   }
@@ -712,10 +884,9 @@ absl::StatusOr<MappedType> Importer::ConvertTemplateSpecializationType(
       clang::dyn_cast_or_null<clang::ClassTemplateSpecializationDecl>(
           type->getAsCXXRecordDecl());
   if (!specialization_decl) {
-    return absl::InvalidArgumentError(absl::Substitute(
-        "Template specialization '$0' without an associated record decl "
-        "is not supported.",
-        type_string));
+    return absl::InvalidArgumentError(
+        absl::StrCat("Template specialization '", type_string,
+                     "' without an associated record decl is not supported."));
   }
 
   if (HasBeenAlreadySuccessfullyImported(specialization_decl))
@@ -734,9 +905,10 @@ absl::StatusOr<MappedType> Importer::ConvertTemplateSpecializationType(
   absl::Status import_status =
       CheckImportStatus(GetDeclItem(specialization_decl));
   if (!import_status.ok()) {
-    return absl::InvalidArgumentError(absl::Substitute(
-        "Failed to create bindings for template specialization type $0: $1",
-        type_string, import_status.message()));
+    return absl::InvalidArgumentError(
+        absl::StrCat("Failed to create bindings for template specialization "
+                     "type ",
+                     type_string, ": ", import_status.message()));
   }
 
   return ConvertTypeDecl(specialization_decl);
@@ -744,8 +916,8 @@ absl::StatusOr<MappedType> Importer::ConvertTemplateSpecializationType(
 
 absl::StatusOr<MappedType> Importer::ConvertTypeDecl(clang::TypeDecl* decl) {
   if (!EnsureSuccessfullyImported(decl)) {
-    return absl::NotFoundError(absl::Substitute(
-        "No generated bindings found for '$0'", decl->getNameAsString()));
+    return absl::NotFoundError(absl::StrCat("No generated bindings found for '",
+                                            decl->getNameAsString(), "'"));
   }
 
   ItemId decl_id = GenerateItemId(decl);
@@ -757,11 +929,51 @@ absl::StatusOr<MappedType> Importer::ConvertType(
     std::optional<clang::tidy::lifetimes::ValueLifetimes>& lifetimes,
     bool nullable) {
   // Qualifiers are handled separately in ConvertQualType().
-  std::string type_string = clang::QualType(type, 0).getAsString();
-
-  if (auto maybe_mapped_type = MapKnownCcTypeToRsType(type_string);
-      maybe_mapped_type.has_value()) {
-    return MappedType::Simple(std::string(*maybe_mapped_type), type_string);
+  //
+  // Builtin types are dispatched on their kind before anything else so that
+  // the (very common) scalar case never materializes a type string;
+  // `getAsString` is one of the hottest allocation sites in the importer.
+  // The string-keyed `MapKnownCcTypeToRsType` probe only matters for sugared
+  // types (`size_t`, `int64_t`, `rs_std::rs_char`, ...), which cannot appear
+  // as `BuiltinType`s because `getAsAdjusted` does not desugar typedefs.
+  //
+  // Use getAsAdjusted instead of getAs so we don't desugar typedefs.
+  if (const auto* builtin_type = type->getAsAdjusted<clang::BuiltinType>()) {
+    switch (builtin_type->getKind()) {
+      case clang::BuiltinType::Bool:
+        return MappedType::Simple("bool", "bool");
+      case clang::BuiltinType::Float:
+        // TODO(b/255768062): Generated bindings should explicitly check if
+        // `math.h` defines the `__STDC_IEC_559__` macro.
+        return MappedType::Simple("f32", "float");
+      case clang::BuiltinType::Double:
+        // TODO(b/255768062): Generated bindings should explicitly check if
+        // `math.h` defines the `__STDC_IEC_559__` macro.
+        return MappedType::Simple("f64", "double");
+      case clang::BuiltinType::Void:
+        return MappedType::Void();
+      // The following kinds were previously handled via the
+      // `MapKnownCcTypeToRsType` probe; keep their mappings bit-identical
+      // (notably `wchar_t` maps to `i32` irrespective of its signedness).
+      case clang::BuiltinType::Char16:
+        return MappedType::Simple("u16", "char16_t");
+      case clang::BuiltinType::Char32:
+        return MappedType::Simple("u32", "char32_t");
+      case clang::BuiltinType::WChar_S:
+      case clang::BuiltinType::WChar_U:
+        return MappedType::Simple("i32", "wchar_t");
+      default:
+        if (builtin_type->isIntegerType()) {
+          auto size = ctx_.getTypeSize(builtin_type);
+          if (size == 8 || size == 16 || size == 32 || size == 64) {
+            // Note: string literals rather than chars; `absl::StrCat` prints
+            // `char` arguments as integers.
+            return MappedType::Simple(
+                absl::StrCat(builtin_type->isSignedInteger() ? "i" : "u", size),
+                clang::QualType(type, 0).getAsString());
+          }
+        }
+    }
   } else if (type->isPointerType() || type->isLValueReferenceType() ||
              type->isRValueReferenceType()) {
     clang::QualType pointee_type = type->getPointeeType();
@@ -779,7 +991,7 @@ absl::StatusOr<MappedType> Importer::ConvertType(
         return absl::UnimplementedError(
             absl::StrCat("Function pointers with non-'static lifetimes are "
                          "not supported: ",
-                         type_string));
+                         clang::QualType(type, 0).getAsString()));
       }
 
       clang::StringRef cc_call_conv =
@@ -827,54 +1039,31 @@ absl::StatusOr<MappedType> Importer::ConvertType(
       return MappedType::RValueReferenceTo(std::move(mapped_pointee_type),
                                            *lifetime);
     }
-  } else if (const auto* builtin_type =
-                 // Use getAsAdjusted instead of getAs so we don't desugar
-                 // typedefs.
-             type->getAsAdjusted<clang::BuiltinType>()) {
-    switch (builtin_type->getKind()) {
-      case clang::BuiltinType::Bool:
-        return MappedType::Simple("bool", "bool");
-        break;
-      case clang::BuiltinType::Float:
-        // TODO(b/255768062): Generated bindings should explicitly check if
-        // `math.h` defines the `__STDC_IEC_559__` macro.
-        return MappedType::Simple("f32", "float");
-        break;
-      case clang::BuiltinType::Double:
-        // TODO(b/255768062): Generated bindings should explicitly check if
-        // `math.h` defines the `__STDC_IEC_559__` macro.
-        return MappedType::Simple("f64", "double");
-        break;
-      case clang::BuiltinType::Void:
-        return MappedType::Void();
-        break;
-      default:
-        if (builtin_type->isIntegerType()) {
-          auto size = ctx_.getTypeSize(builtin_type);
-          if (size == 8 || size == 16 || size == 32 || size == 64) {
-            return MappedType::Simple(
-                absl::Substitute(
-                    "$0$1", builtin_type->isSignedInteger() ? 'i' : 'u', size),
-                type_string);
-          }
-        }
+  } else {
+    // Sugared (typedef / tag / template) types.  The well-known-type probe
+    // is keyed on the printed type name, so the `getAsString` cost is only
+    // paid on this path.
+    std::string type_string = clang::QualType(type, 0).getAsString();
+    if (auto maybe_mapped_type = MapKnownCcTypeToRsType(type_string);
+        maybe_mapped_type.has_value()) {
+      return MappedType::Simple(std::string(*maybe_mapped_type), type_string);
+    } else if (const auto* tag_type = type->getAsAdjusted<clang::TagType>()) {
+      return ConvertTypeDecl(tag_type->getDecl());
+    } else if (const auto* typedef_type =
+                   type->getAsAdjusted<clang::TypedefType>()) {
+      return ConvertTypeDecl(typedef_type->getDecl());
+    } else if (const auto* tst_type =
+                   type->getAs<clang::TemplateSpecializationType>()) {
+      return ConvertTemplateSpecializationType(tst_type);
+    } else if (const auto* subst_type =
+                   type->getAs<clang::SubstTemplateTypeParmType>()) {
+      return ConvertQualType(subst_type->getReplacementType(), lifetimes);
+    } else if (const auto* deduced_type = type->getAs<clang::DeducedType>()) {
+      // Deduction should have taken place earlier (e.g. via DeduceReturnType
+      // called from FunctionDeclImporter::Import).
+      CHECK(deduced_type->isDeduced());
+      return ConvertQualType(deduced_type->getDeducedType(), lifetimes);
     }
-  } else if (const auto* tag_type = type->getAsAdjusted<clang::TagType>()) {
-    return ConvertTypeDecl(tag_type->getDecl());
-  } else if (const auto* typedef_type =
-                 type->getAsAdjusted<clang::TypedefType>()) {
-    return ConvertTypeDecl(typedef_type->getDecl());
-  } else if (const auto* tst_type =
-                 type->getAs<clang::TemplateSpecializationType>()) {
-    return ConvertTemplateSpecializationType(tst_type);
-  } else if (const auto* subst_type =
-                 type->getAs<clang::SubstTemplateTypeParmType>()) {
-    return ConvertQualType(subst_type->getReplacementType(), lifetimes);
-  } else if (const auto* deduced_type = type->getAs<clang::DeducedType>()) {
-    // Deduction should have taken place earlier (e.g. via DeduceReturnType
-    // called from FunctionDeclImporter::Import).
-    CHECK(deduced_type->isDeduced());
-    return ConvertQualType(deduced_type->getDeducedType(), lifetimes);
   }
 
   return absl::UnimplementedError(absl::StrCat(
@@ -904,12 +1093,15 @@ absl::StatusOr<MappedType> Importer::ConvertQualType(
     std::optional<clang::tidy::lifetimes::ValueLifetimes>& lifetimes,
     bool nullable) {
   qual_type = GetUnelaboratedType(std::move(qual_type), ctx_);
-  std::string type_string = qual_type.getAsString();
   absl::StatusOr<MappedType> type =
       ConvertType(qual_type.getTypePtr(), lifetimes, nullable);
   if (!type.ok()) {
-    absl::Status error = absl::UnimplementedError(absl::Substitute(
-        "Unsupported type '$0': $1", type_string, type.status().message()));
+    // The type string is only needed for error reporting; don't pay for the
+    // `getAsString` allocation on the (hot) success path.
+    std::string type_string = qual_type.getAsString();
+    absl::Status error = absl::UnimplementedError(
+        absl::StrCat("Unsupported type '", type_string,
+                     "': ", type.status().message()));
     error.SetPayload(kTypeStatusPayloadUrl, absl::Cord(type_string));
     return error;
   }
@@ -917,8 +1109,8 @@ absl::StatusOr<MappedType> Importer::ConvertQualType(
   // Handle cv-qualification.
   type->cc_type.is_const = qual_type.isConstQualified();
   if (qual_type.isVolatileQualified()) {
-    return absl::UnimplementedError(
-        absl::StrCat("Unsupported `volatile` qualifier: ", type_string));
+    return absl::UnimplementedError(absl::StrCat(
+        "Unsupported `volatile` qualifier: ", qual_type.getAsString()));
   }
 
   return type;
@@ -980,11 +1172,13 @@ std::string Importer::GetMangledName(const clang::NamedDecl* named_decl) const {
     decl = clang::GlobalDecl(named_decl);
   }
 
-  std::string name;
-  llvm::raw_string_ostream stream(name);
+  // Mangle into stack storage first (as the record branch above does);
+  // `raw_string_ostream` would heap-allocate for every decl, while mangled
+  // names usually fit the inline buffer.
+  llvm::SmallString<128> storage;
+  llvm::raw_svector_ostream stream(storage);
   mangler_->mangleName(decl, stream);
-  stream.flush();
-  return name;
+  return std::string(storage.str());
 }
 
 std::string Importer::GetNameForSourceOrder(const clang::Decl* decl) const {
@@ -1018,9 +1212,31 @@ std::string Importer::GetNameForSourceOrder(const clang::Decl* decl) const {
 
 absl::StatusOr<UnqualifiedIdentifier> Importer::GetTranslatedName(
     const clang::NamedDecl* named_decl) const {
-  switch (named_decl->getDeclName().getNameKind()) {
+  // Translated names are requested from several places (decl importers,
+  // `ConvertType` on tag/typedef types, parameter naming), typically more
+  // than once per decl, so the result is memoized per decl pointer.
+  auto it = translated_name_cache_.find(named_decl);
+  if (it != translated_name_cache_.end()) {
+    return it->second;
+  }
+  absl::StatusOr<UnqualifiedIdentifier> name =
+      GetTranslatedNameImpl(named_decl);
+  translated_name_cache_.try_emplace(named_decl, name);
+  return name;
+}
+
+absl::StatusOr<UnqualifiedIdentifier> Importer::GetTranslatedNameImpl(
+    const clang::NamedDecl* named_decl) const {
+  // `NameKind` values are small and dense, so this switch already compiles to
+  // a jump table; a hand-rolled function-pointer array would only defeat
+  // inlining of the trivial cases.
+  clang::DeclarationName decl_name = named_decl->getDeclName();
+  switch (decl_name.getNameKind()) {
     case clang::DeclarationName::Identifier: {
-      auto name = std::string(named_decl->getName());
+      // Keep the name as a `StringRef` for the emptiness/escapability checks;
+      // it is only copied into a `std::string` when the `Identifier` is
+      // actually constructed.
+      llvm::StringRef name = named_decl->getName();
       if (name.empty()) {
         return absl::InvalidArgumentError("Missing identifier");
       }
@@ -1030,18 +1246,19 @@ absl::StatusOr<UnqualifiedIdentifier> Importer::GetTranslatedName(
       // https://doc.rust-lang.org/reference/identifiers.html#identifiers
       if (name == "crate" || name == "self" || name == "super" ||
           name == "Self") {
-        return absl::InvalidArgumentError(
-            absl::StrCat("Unescapable identifier: ", name));
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Unescapable identifier: ",
+            absl::string_view(name.data(), name.size())));
       }
 
-      return {Identifier(std::move(name))};
+      return {Identifier(std::string(name))};
     }
     case clang::DeclarationName::CXXConstructorName:
       return {SpecialName::kConstructor};
     case clang::DeclarationName::CXXDestructorName:
       return {SpecialName::kDestructor};
     case clang::DeclarationName::CXXOperatorName:
-      switch (named_decl->getDeclName().getCXXOverloadedOperator()) {
+      switch (decl_name.getCXXOverloadedOperator()) {
         case clang::OO_None:
           LOG(FATAL) << "No OO_None expected under CXXOperatorName branch";
         case clang::NUM_OVERLOADED_OPERATORS:
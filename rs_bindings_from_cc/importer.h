@@ -26,12 +26,23 @@
 #include "rs_bindings_from_cc/ir.h"
 #include "clang/AST/Mangle.h"
 #include "clang/AST/RawCommentList.h"
+#include "clang/Basic/SourceLocation.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 
 namespace crubit {
 
 // Iterates over the AST created from the invocation's entry headers and
 // creates an intermediate representation of the import (`IR`) into the
 // invocation object.
+//
+// The traversal is driven by the importer itself (iterating `DeclContext`
+// children and recursing through `GetDeclItem`) rather than by a
+// `clang::RecursiveASTVisitor`: only decl kinds with a registered
+// `DeclImporter` are ever visited, and no per-visitor CRTP traversal
+// machinery gets instantiated in this translation unit.
 class Importer final : public ImportContext {
  public:
   explicit Importer(Invocation& invocation, clang::ASTContext& ctx,
@@ -95,7 +106,28 @@ class Importer final : public ImportContext {
   }
 
  private:
-  class SourceOrderKey;
+  // A key that is used for ordering Items in the generated source order.
+  // Defined in the header (rather than just forward-declared) so that keys can
+  // be memoized per decl in `source_order_key_cache_`.
+  class SourceOrderKey {
+   public:
+    SourceOrderKey(const clang::SourceManager& sm,
+                   clang::SourceRange source_range, int decl_order = 0,
+                   std::string name = "");
+
+    SourceOrderKey(const SourceOrderKey&) = default;
+    SourceOrderKey& operator=(const SourceOrderKey&) = default;
+
+    bool isBefore(const SourceOrderKey& other,
+                  const clang::SourceManager& sm) const;
+
+   private:
+    clang::SourceRange source_range_;
+    std::pair<clang::FileID, unsigned> decomposed_begin_;
+    std::pair<clang::FileID, unsigned> decomposed_end_;
+    int decl_order_;
+    std::string name_;
+  };
   class SourceLocationComparator;
 
   // Returns a SourceOrderKey for the given `decl` that should be used for
@@ -108,6 +140,23 @@ class Importer final : public ImportContext {
   // Returns a name for `decl` that should be used for ordering declarations.
   std::string GetNameForSourceOrder(const clang::Decl* decl) const;
 
+  // Uncached implementation of `GetTranslatedName`.
+  absl::StatusOr<UnqualifiedIdentifier> GetTranslatedNameImpl(
+      const clang::NamedDecl* named_decl) const;
+
+  // Returns the raw comment attached to `decl` (or null), memoizing the
+  // underlying (uncached, text-scanning) `getRawCommentForDeclNoCache` call.
+  const clang::RawComment* GetRawComment(const clang::Decl* decl) const;
+
+  // Returns whether the file containing `loc` has any raw comments at all;
+  // used as a cheap negative filter in front of comment-attachment searches.
+  bool FileHasComments(clang::SourceLocation loc) const;
+
+  // Walks up the include stack to find the target owning `source_location`.
+  // Only called on a miss in `owning_target_cache_`; see `GetOwningTarget`.
+  BazelLabel GetOwningTargetUncached(
+      clang::SourceLocation source_location) const;
+
   // Returns the item ids of template instantiations that have been triggered
   // from the current target.  The returned items are in an arbitrary,
   // deterministic/reproducible order.
@@ -130,16 +179,57 @@ class Importer final : public ImportContext {
 
   std::vector<std::unique_ptr<DeclImporter>> decl_importers_;
   std::unique_ptr<clang::MangleContext> mangler_;
-  absl::flat_hash_map<const clang::Decl*, std::optional<IR::Item>>
-      import_cache_;
-  absl::flat_hash_set<const clang::ClassTemplateSpecializationDecl*>
+  // Maps a canonical decl to its imported item.  The cache is probed on every
+  // `GetDeclItem` call, so it uses a `DenseMap` (open addressing, trivial
+  // pointer hashing) rather than a SwissTable keyed on hashed pointers.
+  llvm::DenseMap<const clang::Decl*, std::optional<IR::Item>> import_cache_;
+  // Pointer-keyed like `import_cache_`, so it uses `DenseSet` for the same
+  // reason: trivial pointer hashing instead of `absl::Hash` per probe.
+  llvm::DenseSet<const clang::ClassTemplateSpecializationDecl*>
       class_template_instantiations_;
-  std::vector<const clang::RawComment*> comments_;
+  // Inline storage covers the free comments of a typical set of public
+  // headers, so `ImportFreeComments` usually never heap-allocates for this.
+  llvm::SmallVector<const clang::RawComment*, 64> comments_;
+
+  // Memoizes `GetOwningTarget` results; see the comment there.  `mutable`
+  // because the owning target of a decl is logically const state.
+  mutable llvm::DenseMap<clang::FileID, BazelLabel> owning_target_cache_;
+  // One-entry fast path in front of `owning_target_cache_` for runs of decls
+  // from the same file.  Only consulted while `last_owning_file_id_` is valid.
+  mutable clang::FileID last_owning_file_id_;
+  mutable BazelLabel last_owning_target_;
+  // Memoizes `IsFromCurrentTarget` per file; see the comment there.
+  mutable llvm::DenseMap<clang::FileID, bool> is_from_current_target_cache_;
+
+  // Memoizes `GetRawComment` results; see the comment there.
+  mutable llvm::DenseMap<const clang::Decl*, const clang::RawComment*>
+      raw_comment_cache_;
+
+  // Memoizes `FileHasComments` results; see the comment there.
+  mutable llvm::DenseMap<clang::FileID, bool> file_has_comments_cache_;
+
+  // Memoizes per-FileID filenames (stripped of a leading "./") for
+  // `ConvertSourceLocation`; see the comment there.
+  mutable llvm::DenseMap<clang::FileID, std::string> filename_cache_;
+
+  // Memoizes `GetTranslatedName` results; see the comment there.
+  mutable llvm::DenseMap<const clang::NamedDecl*,
+                         absl::StatusOr<UnqualifiedIdentifier>>
+      translated_name_cache_;
+
+  // Memoizes `GetSourceOrderKey` per decl.  Each imported decl's key is
+  // needed both when its parent collects child item ids and when the final
+  // item list is sorted, and building a key may mangle names (see
+  // `GetNameForSourceOrder`).
+  mutable llvm::DenseMap<const clang::Decl*, SourceOrderKey>
+      source_order_key_cache_;
 
   // Set of decls that have been successfully imported (i.e. that will be
   // present in the IR output / that will not produce dangling ItemIds in the IR
-  // output).
-  absl::flat_hash_set<const clang::TypeDecl*> known_type_decls_;
+  // output).  Keys are canonical decl pointers; `SmallPtrSet` keeps the common
+  // small-TU case in an inline bucket array and avoids hashing on the hot
+  // `HasBeenAlreadySuccessfullyImported` checks in `ConvertType`.
+  llvm::SmallPtrSet<const clang::TypeDecl*, 32> known_type_decls_;
 };  // class Importer
 
 }  // namespace crubit
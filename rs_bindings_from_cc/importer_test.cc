@@ -183,9 +183,20 @@ auto CcTypeParamsAre(const Args&... matchers) {
                         ElementsAre(matchers...));
 }
 
-auto IsCcInt() { return AllOf(NameIs("int"), CcTypeParamsAre()); }
+// The `int` matchers below are used in dozens of expectations; they are
+// cached as concrete `Matcher`s (which are cheaply copyable) so each use
+// doesn't rebuild the composed AllOf tree.
+testing::Matcher<CcType> IsCcInt() {
+  static const auto* const kMatcher =
+      new testing::Matcher<CcType>(AllOf(NameIs("int"), CcTypeParamsAre()));
+  return *kMatcher;
+}
 
-auto IsRsInt() { return AllOf(NameIs("i32"), RsTypeParamsAre()); }
+testing::Matcher<RsType> IsRsInt() {
+  static const auto* const kMatcher =
+      new testing::Matcher<RsType>(AllOf(NameIs("i32"), RsTypeParamsAre()));
+  return *kMatcher;
+}
 
 // Matches a CcType that is a pointer to a type matching `matcher`.
 template <typename Matcher>
@@ -214,15 +225,29 @@ auto RsConstPointsTo(const Matcher& matcher) {
 MATCHER(IsVoid, "") { return arg.IsVoid(); }
 
 // Matches a MappedType that is a pointer to integer.
-auto IsIntPtr() {
-  return AllOf(CcTypeIs(CcPointsTo(IsCcInt())),
-               RsTypeIs(RsPointsTo(IsRsInt())));
+testing::Matcher<MappedType> IsIntPtr() {
+  static const auto* const kMatcher = new testing::Matcher<MappedType>(
+      AllOf(CcTypeIs(CcPointsTo(IsCcInt())), RsTypeIs(RsPointsTo(IsRsInt()))));
+  return *kMatcher;
 }
 
 // Matches a MappedType that is an lvalue reference to integer.
-auto IsIntRef() {
-  return AllOf(CcTypeIs(CcReferenceTo(IsCcInt())),
-               RsTypeIs(RsPointsTo(IsRsInt())));
+testing::Matcher<MappedType> IsIntRef() {
+  static const auto* const kMatcher =
+      new testing::Matcher<MappedType>(AllOf(CcTypeIs(CcReferenceTo(IsCcInt())),
+                                             RsTypeIs(RsPointsTo(IsRsInt()))));
+  return *kMatcher;
+}
+
+// Matches a Func item with the given identifier and mangled name that returns
+// void and takes no parameters.  Returning one concrete `Matcher<IR::Item>`
+// keeps the nested Field/AllOf matcher tree from being instantiated anew in
+// every test that checks a trivial function.
+testing::Matcher<IR::Item> IsVoidFunc(std::string identifier,
+                                      std::string mangled_name) {
+  return VariantWith<Func>(AllOf(IdentifierIs(std::move(identifier)),
+                                 MangledNameIs(std::move(mangled_name)),
+                                 ReturnType(IsVoid()), ParamsAre()));
 }
 
 // Matches a Record that has fields matching `matchers`.
@@ -316,20 +341,14 @@ TEST(ImporterTest, ErrorOnInvalidInput) {
 TEST(ImporterTest, FuncWithVoidReturnType) {
   ASSERT_OK_AND_ASSIGN(IR ir, IrFromCc("void Foo();"));
   EXPECT_THAT(ItemsWithoutBuiltins(ir),
-              UnorderedElementsAre(VariantWith<Func>(
-                  AllOf(IdentifierIs("Foo"), MangledNameIs("_Z3Foov"),
-                        ReturnType(IsVoid()), ParamsAre()))));
+              UnorderedElementsAre(IsVoidFunc("Foo", "_Z3Foov")));
 }
 
 TEST(ImporterTest, TwoFuncs) {
   ASSERT_OK_AND_ASSIGN(IR ir, IrFromCc("void Foo(); void Bar();"));
-  EXPECT_THAT(
-      ItemsWithoutBuiltins(ir),
-      UnorderedElementsAre(
-          VariantWith<Func>(AllOf(IdentifierIs("Foo"), MangledNameIs("_Z3Foov"),
-                                  ReturnType(IsVoid()), ParamsAre())),
-          VariantWith<Func>(AllOf(IdentifierIs("Bar"), MangledNameIs("_Z3Barv"),
-                                  ReturnType(IsVoid()), ParamsAre()))));
+  EXPECT_THAT(ItemsWithoutBuiltins(ir),
+              UnorderedElementsAre(IsVoidFunc("Foo", "_Z3Foov"),
+                                   IsVoidFunc("Bar", "_Z3Barv")));
 }
 
 TEST(ImporterTest, TwoFuncsFromTwoHeaders) {
@@ -4,6 +4,7 @@
 
 #include "rs_bindings_from_cc/importers/cxx_record.h"
 
+#include <iterator>
 #include <optional>
 
 #include "clang/Basic/SourceLocation.h"
@@ -272,7 +273,19 @@ std::optional<IR::Item> CXXRecordDeclImporter::Import(
   // cannot fail.
   ictx_.MarkAsSuccessfullyImported(record_decl);
 
-  ictx_.sema_.ForceDeclarationOfImplicitMembers(record_decl);
+  // `ForceDeclarationOfImplicitMembers` does real Sema work; skip it when all
+  // implicit members have already been declared (common for records whose
+  // special members were used, or spelled out, elsewhere in the TU).  These
+  // `needsImplicit*` checks are exactly the ones the Sema call makes itself
+  // before declaring anything.
+  if (record_decl->needsImplicitDefaultConstructor() ||
+      record_decl->needsImplicitCopyConstructor() ||
+      record_decl->needsImplicitMoveConstructor() ||
+      record_decl->needsImplicitCopyAssignment() ||
+      record_decl->needsImplicitMoveAssignment() ||
+      record_decl->needsImplicitDestructor()) {
+    ictx_.sema_.ForceDeclarationOfImplicitMembers(record_decl);
+  }
 
   const clang::ASTRecordLayout& layout =
       ictx_.ctx_.getASTRecordLayout(record_decl);
@@ -308,15 +321,15 @@ std::optional<IR::Item> CXXRecordDeclImporter::Import(
       .size = layout.getSize().getQuantity(),
       .original_cc_size = layout.getSize().getQuantity(),
       .alignment = layout.getAlignment().getQuantity(),
-      .is_derived_class = is_derived_class,
-      .override_alignment = override_alignment,
+      .record_type = *record_type,
       .copy_constructor = GetCopyCtorSpecialMemberFunc(*record_decl),
       .move_constructor = GetMoveCtorSpecialMemberFunc(*record_decl),
       .destructor = GetDestructorSpecialMemberFunc(*record_decl),
+      .is_derived_class = is_derived_class,
+      .override_alignment = override_alignment,
       .is_trivial_abi = record_decl->canPassInRegisters(),
       .is_inheritable = !is_effectively_final,
       .is_abstract = record_decl->isAbstract(),
-      .record_type = *record_type,
       .is_aggregate = record_decl->isAggregate(),
       .is_anon_record_with_typedef = anon_typedef != nullptr,
       .is_explicit_class_template_instantiation_definition =
@@ -364,6 +377,8 @@ std::vector<Field> CXXRecordDeclImporter::ImportFields(
   clang::AccessSpecifier default_access =
       record_decl->isClass() ? clang::AS_private : clang::AS_public;
   std::vector<Field> fields;
+  fields.reserve(
+      std::distance(record_decl->field_begin(), record_decl->field_end()));
   const clang::ASTRecordLayout& layout =
       ictx_.ctx_.getASTRecordLayout(record_decl);
   for (const clang::FieldDecl* field_decl : record_decl->fields()) {
@@ -6,10 +6,13 @@
 
 #include <optional>
 
-#include "absl/strings/substitute.h"
+#include "absl/strings/str_cat.h"
 #include "rs_bindings_from_cc/ast_util.h"
 #include "clang/Sema/Sema.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace crubit {
 
@@ -29,7 +32,12 @@ Identifier FunctionDeclImporter::GetTranslatedParamName(
   int param_pos = param_decl->getFunctionScopeIndex();
   absl::StatusOr<Identifier> name = ictx_.GetTranslatedIdentifier(param_decl);
   if (!name.ok()) {
-    return {Identifier(absl::StrCat("__param_", param_pos))};
+    // Format into stack storage; C-style headers can have a lot of unnamed
+    // parameters, and `StrCat` would allocate an intermediate string each
+    // time.
+    llvm::SmallString<16> fallback_name;
+    llvm::raw_svector_ostream(fallback_name) << "__param_" << param_pos;
+    return {Identifier(std::string(fallback_name))};
   }
   if (auto* sttpt =
           param_decl->getType()->getAs<clang::SubstTemplateTypeParmType>();
@@ -68,9 +76,10 @@ std::optional<IR::Item> FunctionDeclImporter::Import(
           "cannot be instantiated in user crates");
     }
   }
+  auto* method_decl = clang::dyn_cast<clang::CXXMethodDecl>(function_decl);
+
   // Method is private, we don't need to import it.
-  if (auto* method_decl =
-          clang::dyn_cast<clang::CXXMethodDecl>(function_decl)) {
+  if (method_decl != nullptr) {
     switch (method_decl->getAccess()) {
       case clang::AS_public:
         break;
@@ -102,13 +111,14 @@ std::optional<IR::Item> FunctionDeclImporter::Import(
   }
 
   std::vector<FuncParam> params;
+  params.reserve(function_decl->getNumParams() +
+                 (method_decl != nullptr ? 1 : 0));
   std::set<std::string> errors;
   auto add_error = [&errors](std::string msg) {
     auto result = errors.insert(std::move(msg));
     CHECK(result.second) << "Duplicated error message";
   };
-  if (auto* method_decl =
-          clang::dyn_cast<clang::CXXMethodDecl>(function_decl)) {
+  if (method_decl != nullptr) {
     if (!ictx_.HasBeenAlreadySuccessfullyImported(method_decl->getParent())) {
       return ictx_.ImportUnsupportedItem(function_decl,
                                          "Couldn't import the parent");
@@ -144,14 +154,14 @@ std::optional<IR::Item> FunctionDeclImporter::Import(
     }
     auto param_type = ictx_.ConvertQualType(param->getType(), param_lifetimes);
     if (!param_type.ok()) {
-      add_error(absl::Substitute("Parameter #$0 is not supported: $1", i,
-                                 param_type.status().message()));
+      add_error(absl::StrCat("Parameter #", i, " is not supported: ",
+                             param_type.status().message()));
       continue;
     }
 
     std::optional<Identifier> param_name = GetTranslatedParamName(param);
     CHECK(param_name.has_value());  // No known failure cases.
-    params.push_back({*param_type, *std::move(param_name)});
+    params.push_back({*std::move(param_type), *std::move(param_name)});
   }
 
   if (function_decl->getReturnType()->isUndeducedType()) {
@@ -179,22 +189,30 @@ std::optional<IR::Item> FunctionDeclImporter::Import(
     all_free_lifetimes = lifetimes->AllFreeLifetimes();
   }
 
+  // Sort the lifetimes by their numeric id (an integer compare) before
+  // looking up their names; ids are assigned in order of first appearance,
+  // so this keeps the emitted order deterministic without comparing name
+  // strings.  Functions rarely have more than a handful of lifetimes, hence
+  // the inline-capacity vector.
+  llvm::SmallVector<clang::tidy::lifetimes::Lifetime, 4> sorted_free_lifetimes(
+      all_free_lifetimes.begin(), all_free_lifetimes.end());
+  llvm::sort(sorted_free_lifetimes,
+             [](clang::tidy::lifetimes::Lifetime l1,
+                clang::tidy::lifetimes::Lifetime l2) {
+               return l1.Id() < l2.Id();
+             });
   std::vector<LifetimeName> lifetime_params;
-  for (clang::tidy::lifetimes::Lifetime lifetime : all_free_lifetimes) {
+  lifetime_params.reserve(sorted_free_lifetimes.size());
+  for (clang::tidy::lifetimes::Lifetime lifetime : sorted_free_lifetimes) {
     std::optional<llvm::StringRef> name =
         lifetime_symbol_table.LookupLifetime(lifetime);
     CHECK(name.has_value());
     lifetime_params.push_back(
         {.name = name->str(), .id = LifetimeId(lifetime.Id())});
   }
-  llvm::sort(lifetime_params,
-             [](const LifetimeName& l1, const LifetimeName& l2) {
-               return l1.name < l2.name;
-             });
 
   std::optional<MemberFuncMetadata> member_func_metadata;
-  if (auto* method_decl =
-          clang::dyn_cast<clang::CXXMethodDecl>(function_decl)) {
+  if (method_decl != nullptr) {
     std::optional<MemberFuncMetadata::InstanceMethodMetadata> instance_metadata;
     if (method_decl->isInstance()) {
       MemberFuncMetadata::ReferenceQualification reference;
@@ -264,8 +282,8 @@ std::optional<IR::Item> FunctionDeclImporter::Import(
       .return_type = *return_type,
       .params = std::move(params),
       .lifetime_params = std::move(lifetime_params),
-      .is_inline = function_decl->isInlined(),
       .member_func_metadata = std::move(member_func_metadata),
+      .is_inline = function_decl->isInlined(),
       .has_c_calling_convention = has_c_calling_convention,
       .is_member_or_descendant_of_class_template =
           is_member_or_descendant_of_class_template,
@@ -7,9 +7,11 @@
 #include <optional>
 
 #include "absl/log/check.h"
+#include "absl/strings/string_view.h"
 #include "rs_bindings_from_cc/known_types_map.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Decl.h"
+#include "llvm/ADT/StringRef.h"
 
 namespace crubit {
 
@@ -37,8 +39,18 @@ std::optional<IR::Item> crubit::TypedefNameDeclImporter::Import(
     // into their item, instead of having a separate TypeAlias item in addition.
     return std::nullopt;
   }
-  if (MapKnownCcTypeToRsType(type.getAsString()).has_value()) {
-    return std::nullopt;
+  // All well-known types also match on the typedef's unqualified name, so use
+  // that as a cheap rejection filter before materializing the qualified type
+  // string (`getAsString` allocates on every call).  The `rs_char` comparison
+  // covers the `rs_std::rs_char` entries, whose unqualified spelling is not a
+  // map key itself.
+  if (llvm::StringRef name = typedef_name_decl->getName();
+      name == "rs_char" ||
+      MapKnownCcTypeToRsType(absl::string_view(name.data(), name.size()))
+          .has_value()) {
+    if (MapKnownCcTypeToRsType(type.getAsString()).has_value()) {
+      return std::nullopt;
+    }
   }
 
   absl::StatusOr<Identifier> identifier =
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
@@ -85,6 +86,42 @@ inline bool operator==(const HeaderName& lhs, const HeaderName& rhs) {
   return lhs.IncludePath() == rhs.IncludePath();
 }
 
+// Transparent hash and equality functors for containers keyed on `HeaderName`.
+// They allow such containers to be probed with a plain `absl::string_view`
+// include path, without materializing a `HeaderName` (and its backing
+// `std::string`) per lookup.
+struct HeaderNameHash {
+  using is_transparent = void;
+
+  size_t operator()(const HeaderName& header) const {
+    return absl::Hash<absl::string_view>()(header.IncludePath());
+  }
+  size_t operator()(absl::string_view include_path) const {
+    return absl::Hash<absl::string_view>()(include_path);
+  }
+};
+
+struct HeaderNameEq {
+  using is_transparent = void;
+
+  template <typename LhsT, typename RhsT>
+  bool operator()(const LhsT& lhs, const RhsT& rhs) const {
+    return IncludePath(lhs) == IncludePath(rhs);
+  }
+
+ private:
+  static absl::string_view IncludePath(const HeaderName& header) {
+    return header.IncludePath();
+  }
+  static absl::string_view IncludePath(absl::string_view include_path) {
+    return include_path;
+  }
+};
+
+// Maps a header to the label of the target that owns it.
+using HeaderNameToTargetMap =
+    absl::flat_hash_map<HeaderName, BazelLabel, HeaderNameHash, HeaderNameEq>;
+
 inline std::ostream& operator<<(std::ostream& o, const HeaderName& h) {
   return o << std::string(llvm::formatv("{0:2}", h.ToJson()));
 }
@@ -435,11 +472,14 @@ struct Func {
   MappedType return_type;
   std::vector<FuncParam> params;
   std::vector<LifetimeName> lifetime_params;
-  bool is_inline;
   // If null, this is not a member function.
   std::optional<MemberFuncMetadata> member_func_metadata;
-  bool has_c_calling_convention = true;
-  bool is_member_or_descendant_of_class_template = false;
+  // Packed into adjacent single-bit fields so the three flags share one
+  // padding-sized slot; bit-fields can't have default member initializers
+  // until C++20, so the construction site in `function.cc` sets all of them.
+  bool is_inline : 1;
+  bool has_c_calling_convention : 1;
+  bool is_member_or_descendant_of_class_template : 1;
   std::string source_loc;
   ItemId id;
   std::optional<ItemId> enclosing_namespace_id;
@@ -570,8 +610,23 @@ struct Record {
   int64_t original_cc_size;
   int64_t alignment;
 
+  // Whether this `Record` corresponds to a C++ `union`, `struct`, or `class`.
+  RecordType record_type;
+
+  // Special member functions.
+  SpecialMemberFunc copy_constructor = SpecialMemberFunc::kUnavailable;
+  SpecialMemberFunc move_constructor = SpecialMemberFunc::kUnavailable;
+  SpecialMemberFunc destructor = SpecialMemberFunc::kUnavailable;
+
+  // The boolean properties below are packed into single-bit fields (and kept
+  // adjacent to the single-byte members above) so that they all share one
+  // 8-byte slot; as plain `bool`s interleaved with the other members they
+  // cost 16 bytes of every `Record` in `IR::items`.  Bit-fields can't have
+  // default member initializers until C++20, so the construction site in
+  // `cxx_record.cc` initializes every one of them explicitly.
+
   // True if any base classes exist.
-  bool is_derived_class;
+  bool is_derived_class : 1;
 
   // True if the alignment may differ from what the fields would imply.
   //
@@ -581,12 +636,7 @@ struct Record {
   // alignment adjustment as necessary, via .override_alignment=true.
   //
   // More information: docs/struct_layout
-  bool override_alignment = false;
-
-  // Special member functions.
-  SpecialMemberFunc copy_constructor = SpecialMemberFunc::kUnavailable;
-  SpecialMemberFunc move_constructor = SpecialMemberFunc::kUnavailable;
-  SpecialMemberFunc destructor = SpecialMemberFunc::kUnavailable;
+  bool override_alignment : 1;
 
   // Whether this type is passed by value as if it were a trivial type (the same
   // as it would be if it were a struct in C).
@@ -596,7 +646,7 @@ struct Record {
   //
   //  * https://eel.is/c++draft/class.temporary#3
   //  * https://clang.llvm.org/docs/AttributeReference.html#trivial-abi
-  bool is_trivial_abi = false;
+  bool is_trivial_abi : 1;
 
   // Whether this type can be inherited from.
   //
@@ -604,28 +654,25 @@ struct Record {
   // * The type was explicitly marked final
   // * A core function like the destructor was marked final
   // * The type is a C++ union, which does not support inheritance
-  bool is_inheritable = false;
+  bool is_inheritable : 1;
 
   // Whether this type is abstract.
-  bool is_abstract = false;
-
-  // Whether this `Record` corresponds to a C++ `union`, `struct`, or `class`.
-  RecordType record_type;
+  bool is_abstract : 1;
 
   // Whether this type can be initialized using aggregate initialization syntax.
   //
   // For more context, see:
   // * https://en.cppreference.com/w/cpp/types/is_aggregate
   // * https://en.cppreference.com/w/cpp/language/aggregate_initialization
-  bool is_aggregate = false;
+  bool is_aggregate : 1;
 
   // It is an anoymous record with a typedef name.
-  bool is_anon_record_with_typedef = false;
+  bool is_anon_record_with_typedef : 1;
 
   // True when this record is created from an explicit class template
   // instantiation definition (which is also what cc_template!{} macro results
   // in).
-  bool is_explicit_class_template_instantiation_definition = false;
+  bool is_explicit_class_template_instantiation_definition : 1;
 
   std::vector<ItemId> child_item_ids;
   std::optional<ItemId> enclosing_namespace_id;
@@ -773,6 +820,13 @@ struct IR {
 
   using Item = std::variant<Func, Record, IncompleteRecord, Enum, TypeAlias,
                             UnsupportedItem, Comment, Namespace, UseMod>;
+  // Deliberately a single interleaved vector of variants rather than one
+  // vector per alternative plus an order index: every consumer (`ToJson`, the
+  // `get_items_if` accessors, `std::visit` dispatch in tests) needs the items
+  // in source order, and the IR crosses the C++/Rust boundary as ordered JSON,
+  // so a struct-of-arrays split would only move the interleaving cost to every
+  // use site.  Items are built once and then streamed out; nothing iterates
+  // them often enough for the per-element variant padding to matter.
   std::vector<Item> items;
   std::vector<ItemId> top_level_item_ids;
   // Empty string signals that the bindings should be generated in the crate
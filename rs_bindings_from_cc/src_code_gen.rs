@@ -253,6 +253,15 @@ fn can_skip_cc_thunk(db: &dyn BindingsGenerator, func: &Func) -> bool {
     // correct. ThinLTO builds will be able to see through the thunk and inline
     // code across the language boundary. For non-ThinLTO builds we plan to
     // implement <internal link> which removes the runtime performance overhead.
+    //
+    // Note that annotating the generated thunks themselves (e.g. with
+    // `always_inline`, or emitting them as `__attribute__((alias(...)))` of
+    // the callee) would not help here: the caller is Rust code compiled in a
+    // separate rustc invocation, so without cross-language LTO the call can't
+    // be folded regardless of attributes on the C++ side. For the
+    // ABI-compatible case we already do strictly better than an alias - no
+    // thunk is emitted at all and the Rust side links directly against the
+    // C++ symbol via `#[link_name]` (see `generate_func_thunk`).
     if func.is_inline {
         return false;
     }
@@ -3988,7 +3997,13 @@ fn generate_func_thunk_impl(db: &dyn BindingsGenerator, func: &Func) -> Result<T
         .map(|p| {
             let formatted = format_cc_type(&p.type_.cc_type, &ir)?;
             if !db.rs_type_kind(p.type_.rs_type.clone())?.is_c_abi_compatible_by_value() {
-                // non-Unpin types are wrapped by a pointer in the thunk.
+                // non-Unpin types are wrapped by a pointer in the thunk: Rust
+                // passes ownership of the in-place value by pointer and the
+                // thunk forwards it with `std::move(*p)`.  This also avoids
+                // materializing an extra by-value temporary (one nontrivial
+                // move construction plus one destructor call per invocation)
+                // in the thunk, and mirrors how the Itanium ABI already passes
+                // non-trivially-copyable types (by hidden reference).
                 Ok(quote! {#formatted *})
             } else {
                 Ok(formatted)